@@ -153,28 +153,47 @@ int ina23x_format_read(struct ina23x_data *spec, uint8_t reg, int *buf){
         return err;
     }
 
+    return ina23x_format(spec, reg, tempRead, buf);
+
+}
+
+/** @brief Format raw data of a specific register of the ina23x.
+ * 
+ * Unlike ina23x_format_read(), it does not wait for a conversion, so
+ * several registers of the same conversion can be read then formatted.
+ * 
+ * @param spec ina23x object with DT spec and calibration values.
+ * @param reg ina23x register the raw data was read from.
+ * @param raw Raw register value.
+ * @param buf Memory pool that stores the formatted data. Shunt = uV,
+ * Bus = mV, Power = uW and Current = uA.
+ *
+ * @retval 0 If successful.
+ * @retval -output error number.
+ */
+int ina23x_format(const struct ina23x_data *spec, uint8_t reg, uint16_t raw, int *buf){
     switch (reg){
     case INA23X_SHUNT_VOLTAGE:
         // LSB is 2.5 uV (output in uV)
-        *buf = round(tempRead*2.5);
+        *buf = round(raw*2.5);
         break;
     case INA23X_BUS_VOLTAGE:
         // LSB is 1.25 mV (output in mV)
-        *buf = round(tempRead*1.25);
+        *buf = round(raw*1.25);
         break;
     case INA23X_POWER:
         // LSB is 25x current LSB (output in uW)
-        *buf = round(tempRead*spec->power_lsb_uW);
+        *buf = round(raw*spec->power_lsb_uW);
         break;
     case INA23X_CURRENT:
         // LSB is given in initialization (output in uA)
-        *buf = round(tempRead*spec->current_lsb_uA);
+        *buf = round(raw*spec->current_lsb_uA);
         break;
     case INA23X_CONFIG:
     case INA23X_CALIBRATION:
     case INA231_MASK_ENABLE:
     case INA231_ALERT_LIMIT:
-        *buf = tempRead;
+        *buf = raw;
         break;
     default:
         printk("Invalid ina23x register selected! (0x%x does not exist)\n",reg);
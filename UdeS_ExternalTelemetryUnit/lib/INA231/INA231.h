@@ -34,6 +34,8 @@
 
 /* settings - depend on use case */
 #define INA231_CONFIG_DEFAULT		0x4527	/* Averages = 16, CT = 1.1 ms, triggered */
+#define INA231_CONFIG_FAST		    0x4007	/* Averages = 1, CT = 140 us, continuous */
+#define INA231_CONFIG_FAST_SHUNT	0x4005	/* Averages = 1, CT = 140 us, continuous, shunt only */
 #define INA231_CALIB_DEFAULT        0x42AB  /* 30 mOhm Shunt and 0.01 mA LSB */
 
 #define INA2XX_RSHUNT_DEFAULT		30000 /* In uOhms */
@@ -64,8 +66,10 @@ int ina23x_init(struct ina23x_data *spec, int rShunt, int currentLSB);
 int ina23x_read(struct ina23x_data *spec, uint8_t reg, uint16_t *buf);
 int ina23x_write(struct ina23x_data *spec, uint8_t reg, uint16_t buf);
 int ina23x_format_read(struct ina23x_data *spec, uint8_t reg, int *buf);
+int ina23x_format(const struct ina23x_data *spec, uint8_t reg, uint16_t raw, int *buf);
 int ina23x_alert_enable_set(struct ina23x_data *spec, uint16_t bitmask, bool pol, bool latch);
 int ina23x_alert_enable_read(struct ina23x_data *spec, uint16_t *buf);
+int ina23x_alert_limit_set(struct ina23x_data *spec, uint16_t buf);
 bool ina23x_conversion_ready(struct ina23x_data *spec);
 bool ina23x_power_down(struct ina23x_data *spec);
 bool ina23x_power_up(struct ina23x_data *spec);
@@ -0,0 +1,101 @@
+/** @file       boot_time.c
+ *  @brief      Time-to-ready measurement of the boot phases.
+ *
+ *  Times are taken from the kernel uptime, so they are relative to the
+ *  kernel start and are valid before the timebase runs.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+/* INCLUDES *******************************************************************/
+#include "boot_time.h"
+
+struct boot_phase_time {
+	uint64_t begin_us;
+	uint64_t end_us;
+	bool done;
+};
+
+static struct boot_phase_time phases[BOOT_PHASE_COUNT];
+static const char *const phase_names[BOOT_PHASE_COUNT] = {
+	[BOOT_PHASE_CONSOLE] = "Console",
+	[BOOT_PHASE_INA] = "ina231",
+	[BOOT_PHASE_UWB] = "UWB",
+	[BOOT_PHASE_BT] = "Bluetooth",
+};
+static uint64_t first_sample_us;
+static bool first_sample_done;
+static bool reported;
+
+/* PRIVATE FUNCTIONS **********************************************************/
+
+static uint64_t uptime_us(void){
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+static void print_ms(uint64_t us){
+	printk("%u.%03u ms", (uint32_t)(us / 1000), (uint32_t)(us % 1000));
+}
+
+/* PUBLIC FUNCTIONS ***********************************************************/
+
+/** @brief Mark the beginning of a boot phase.
+ *
+ * @param phase Boot phase.
+ */
+void boot_phase_begin(enum boot_phase phase){
+	phases[phase].begin_us = uptime_us();
+}
+
+/** @brief Mark the end of a boot phase.
+ *
+ * @param phase Boot phase.
+ */
+void boot_phase_end(enum boot_phase phase){
+	phases[phase].end_us = uptime_us();
+	phases[phase].done = true;
+}
+
+/** @brief Mark the first telemetry sample. Only the first call is kept.
+ */
+void boot_first_sample(void){
+	if (!first_sample_done){
+		first_sample_us = uptime_us();
+		first_sample_done = true;
+	}
+}
+
+/** @brief Print the boot breakdown once every phase is done.
+ *
+ * @return TRUE once the report was printed, then it is not printed again.
+ */
+bool boot_time_report(void){
+	if (reported){
+		return true;
+	}
+	if (!first_sample_done){
+		return false;
+	}
+	for (int i = 0; i < BOOT_PHASE_COUNT; i++){
+		if (!phases[i].done){
+			return false;
+		}
+	}
+
+	printk("Boot time (since kernel start):\n");
+	for (int i = 0; i < BOOT_PHASE_COUNT; i++){
+		printk("  %-10s: ", phase_names[i]);
+		print_ms(phases[i].begin_us);
+		printk(" -> ");
+		print_ms(phases[i].end_us);
+		printk(" (");
+		print_ms(phases[i].end_us - phases[i].begin_us);
+		printk(")\n");
+	}
+	printk("  First telemetry sample at ");
+	print_ms(first_sample_us);
+	printk("\n");
+	reported = true;
+
+	return true;
+}
@@ -0,0 +1,28 @@
+/** @file       boot_time.h
+ *  @brief      Time-to-ready measurement of the boot phases.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+#ifndef BOOT_TIME_H_
+#define BOOT_TIME_H_
+
+/* INCLUDES *******************************************************************/
+#include <zephyr/kernel.h>
+
+/* Boot phases, some of them run concurrently */
+enum boot_phase {
+	BOOT_PHASE_CONSOLE,		/* USB console and LEDs */
+	BOOT_PHASE_INA,			/* ina231 init, in the sensor task */
+	BOOT_PHASE_UWB,			/* Cortical implant init */
+	BOOT_PHASE_BT,			/* bt_enable() until the ready callback */
+	BOOT_PHASE_COUNT
+};
+
+/* PUBLIC FUNCTION PROTOTYPES *************************************************/
+void boot_phase_begin(enum boot_phase phase);
+void boot_phase_end(enum boot_phase phase);
+void boot_first_sample(void);
+bool boot_time_report(void);
+
+#endif /* BOOT_TIME_H_ */
@@ -0,0 +1,473 @@
+/** @file       energy_profiler.c
+ *  @brief      Energy attribution of the UWB and BLE events.
+ *
+ *  While the profiler is enabled, the UWB and MCU ina231 are kept in fast
+ *  continuous conversion and reserved for it. A UWB event is bracketed by
+ *  energy_profiler_begin() and energy_profiler_end(). A BLE event is the
+ *  radio activity of the connection event that sends the notifications
+ *  queued before energy_profiler_arm(). It is bracketed by the MPSL radio
+ *  notifications. In between, a high priority sampler thread reads the
+ *  power of the event rail as fast as the I2C bus allows and integrates it
+ *  over the timebase.
+ *
+ *  The rail also powers whatever runs beside the event, including the
+ *  sampler and its I2C reads. After every event, the sampler measures an
+ *  idle baseline window on the same rail at the same read rate. Events are
+ *  recorded net of the average idle power over their duration.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+/* INCLUDES *******************************************************************/
+#include "energy_profiler.h"
+#include "timebase.h"
+#include <mpsl_radio_notification.h>
+
+/* Software interrupt raised by MPSL when the radio turns on and off */
+#define RADIO_NOTIFICATION_IRQn		SWI3_EGU3_IRQn
+#define RADIO_NOTIFICATION_PRIO		2
+/* Longer than any connection event of a few notifications. An interrupt
+ * after a longer gap is always a radio active one. */
+#define RADIO_EVENT_MAX_US			10000
+
+#define HIST_BINS	CONFIG_APP_ENERGY_PROFILER_HIST_BINS
+#define BASELINE_US	(CONFIG_APP_ENERGY_PROFILER_BASELINE_MS * USEC_PER_MSEC)
+
+enum window_state {
+	WINDOW_IDLE,
+	WINDOW_ARMED,		/* Waiting for the radio, BLE only */
+	WINDOW_OPEN,
+	WINDOW_CLOSING,
+	WINDOW_BASELINE,
+};
+
+struct energy_window {
+	struct ina23x_data *rail;
+	atomic_t state;
+
+	/* Current window, written by the sampler thread and by the radio ISR for BLE */
+	uint64_t start_us;
+	uint64_t end_us;
+	uint64_t prev_us;
+	int prev_uW;
+	bool has_sample;
+	uint64_t energy_pJ;
+	uint32_t samples;
+	uint32_t read_errors;
+
+	/* Units and bytes of the current event, recorded when it closes */
+	uint32_t pending_units;
+	uint32_t pending_bytes;
+	bool baseline_void;		/* The radio was active during the baseline */
+
+	/* Idle baseline over all baseline windows, the sums are sampler only */
+	uint64_t idle_pJ;
+	uint64_t idle_us;
+	uint32_t idle_uW;		/* Average idle power, 0 before the first baseline */
+	uint32_t baselines;
+
+	/* Statistics over all windows, net of the idle baseline */
+	uint32_t events;
+	uint32_t unbaselined;	/* Windows closed before any baseline */
+	uint32_t void_baselines;
+	uint32_t idle_events;	/* Windows with no unit */
+	uint32_t units;
+	uint32_t bytes;
+	uint64_t total_pJ;
+	uint64_t units_pJ;	/* Energy of the windows with units */
+	uint64_t bytes_pJ;	/* Energy of the windows with payload */
+	uint64_t total_samples;
+	uint32_t hist_unit[HIST_BINS];
+	uint32_t hist_byte[HIST_BINS];
+};
+
+static struct energy_window windows[ENERGY_EVENT_COUNT];
+static const char *const event_names[ENERGY_EVENT_COUNT] = {
+	[ENERGY_EVENT_UWB] = "UWB",
+	[ENERGY_EVENT_BLE] = "BLE",
+};
+/* What the energy of an event is divided by */
+static const char *const unit_names[ENERGY_EVENT_COUNT] = {
+	[ENERGY_EVENT_UWB] = "IRQ",
+	[ENERGY_EVENT_BLE] = "frame",
+};
+
+static bool radio_active;
+static uint64_t radio_last_us;
+
+static K_SEM_DEFINE(sampler_wake, 0, 1);
+
+static void sampler_task(void *p1, void *p2, void *p3);
+
+K_THREAD_DEFINE(energy_sampler_tid, CONFIG_APP_ENERGY_PROFILER_STACK_SIZE, sampler_task,
+	NULL, NULL, NULL, CONFIG_APP_ENERGY_PROFILER_PRIORITY, 0, 0);
+
+/* PRIVATE FUNCTIONS **********************************************************/
+
+static void hist_add(uint32_t *hist, uint64_t value_nJ, uint32_t bin_nJ){
+	uint64_t bin = value_nJ / bin_nJ;
+
+	hist[MIN(bin, HIST_BINS - 1)]++;
+}
+
+static void hist_print(const char *unit, const uint32_t *hist, uint32_t bin_nJ){
+	printk("  uJ/%s histogram:\n", unit);
+	for (int i = 0; i < HIST_BINS; i++){
+		uint32_t low = i * bin_nJ;
+
+		if (!hist[i]){
+			continue;
+		}
+		if (i == HIST_BINS - 1){
+			printk("    >= %u.%03u uJ : %u\n", low / 1000, low % 1000, hist[i]);
+		}else{
+			printk("    %u.%03u - %u.%03u uJ : %u\n", low / 1000, low % 1000,
+				(low + bin_nJ) / 1000, (low + bin_nJ) % 1000, hist[i]);
+		}
+	}
+}
+
+/* Trapezoidal integration of the power between two reads. P (uW) * t (us) = pJ */
+static void window_sample(struct energy_window *w){
+	uint16_t raw = 0;
+	uint64_t now;
+	int power_uW;
+
+	if (ina23x_read(w->rail, INA23X_POWER, &raw)){
+		w->read_errors++;
+		// Let the event task run, a failing bus would not block this thread
+		k_sleep(K_TICKS(1));
+		return;
+	}
+	now = timebase_now_us();
+	power_uW = raw * w->rail->power_lsb_uW;
+
+	if (!w->has_sample){
+		w->prev_uW = power_uW;
+		w->has_sample = true;
+	}
+	w->energy_pJ += (uint64_t)(w->prev_uW + power_uW) * (now - w->prev_us) / 2;
+	w->prev_uW = power_uW;
+	w->prev_us = now;
+	w->samples++;
+}
+
+/* Hold the last power read until the end of the window */
+static void window_finish(struct energy_window *w){
+	if (w->has_sample && w->end_us > w->prev_us){
+		w->energy_pJ += (uint64_t)w->prev_uW * (w->end_us - w->prev_us);
+	}
+}
+
+/* Restart the integration for the next window */
+static void window_reset(struct energy_window *w, uint64_t now){
+	w->energy_pJ = 0;
+	w->samples = 0;
+	w->has_sample = false;
+	w->start_us = now;
+	w->prev_us = now;
+}
+
+/* Record the energy of the closed event, net of the idle power of the rail
+ * over its duration. Events closed before the first baseline are not recorded. */
+static void window_record(struct energy_window *w){
+	uint32_t units = w->pending_units;
+	uint32_t bytes = w->pending_bytes;
+	uint64_t idle_pJ;
+	uint64_t net_pJ;
+	uint64_t energy_nJ;
+
+	if (!w->baselines){
+		w->unbaselined++;
+		return;
+	}
+
+	idle_pJ = (uint64_t)w->idle_uW * (w->end_us - w->start_us);
+	net_pJ = (w->energy_pJ > idle_pJ) ? w->energy_pJ - idle_pJ : 0;
+	energy_nJ = net_pJ / 1000;
+	w->events++;
+	w->total_pJ += net_pJ;
+	w->total_samples += w->samples;
+	if (!units){
+		w->idle_events++;
+		return;
+	}
+
+	w->units += units;
+	w->units_pJ += net_pJ;
+	hist_add(w->hist_unit, energy_nJ / units, CONFIG_APP_ENERGY_PROFILER_FRAME_BIN_NJ);
+	if (bytes){
+		w->bytes += bytes;
+		w->bytes_pJ += net_pJ;
+		hist_add(w->hist_byte, energy_nJ / bytes, CONFIG_APP_ENERGY_PROFILER_BYTE_BIN_NJ);
+	}
+}
+
+/* Record the event and start the baseline window of its rail */
+static void window_close(struct energy_window *w){
+	window_finish(w);
+	window_record(w);
+	window_reset(w, timebase_now_us());
+	w->baseline_void = false;
+	atomic_set(&w->state, WINDOW_BASELINE);
+}
+
+static void baseline_sample(struct energy_window *w){
+	window_sample(w);
+	if (timebase_now_us() - w->start_us < BASELINE_US){
+		return;
+	}
+
+	// A baseline without any read or with radio activity is dropped
+	if (w->baseline_void){
+		w->void_baselines++;
+	}else if (w->has_sample && w->prev_us > w->start_us){
+		w->idle_pJ += w->energy_pJ;
+		w->idle_us += w->prev_us - w->start_us;
+		w->idle_uW = (uint32_t)(w->idle_pJ / w->idle_us);
+		w->baselines++;
+	}
+	atomic_set(&w->state, WINDOW_IDLE);
+}
+
+/* Open the armed BLE window when the radio turns on and close it when the
+ * radio turns off. Both notifications raise the same interrupt. */
+static void radio_notification_isr(const void *arg){
+	struct energy_window *w = &windows[ENERGY_EVENT_BLE];
+	uint64_t now = timebase_now_us();
+
+	// Resynchronize on a long gap, in case the first interrupt was a radio inactive one
+	radio_active = !radio_active || (now - radio_last_us > RADIO_EVENT_MAX_US);
+	radio_last_us = now;
+
+	if (radio_active){
+		switch (atomic_get(&w->state)){
+		case WINDOW_ARMED:
+			window_reset(w, now);
+			atomic_set(&w->state, WINDOW_OPEN);
+			k_sem_give(&sampler_wake);
+			break;
+		case WINDOW_BASELINE:
+			w->baseline_void = true;
+			break;
+		default:
+			break;
+		}
+	}else if (atomic_get(&w->state) == WINDOW_OPEN){
+		w->end_us = now;
+		atomic_set(&w->state, WINDOW_CLOSING);
+		k_sem_give(&sampler_wake);
+	}
+}
+
+static void sampler_task(void *p1, void *p2, void *p3){
+	bool active;
+
+	for (;;){
+		k_sem_take(&sampler_wake, K_FOREVER);
+
+		do {
+			active = false;
+			for (int i = 0; i < ENERGY_EVENT_COUNT; i++){
+				struct energy_window *w = &windows[i];
+
+				switch (atomic_get(&w->state)){
+				case WINDOW_OPEN:
+					window_sample(w);
+					active = true;
+					break;
+				case WINDOW_CLOSING:
+					window_close(w);
+					active = true;
+					break;
+				case WINDOW_BASELINE:
+					baseline_sample(w);
+					active = true;
+					break;
+				default:
+					break;
+				}
+			}
+		} while (active);
+	}
+}
+
+/* PUBLIC FUNCTIONS ***********************************************************/
+
+/** @brief Reserve the UWB and MCU rails and set them to fast conversions.
+ *
+ * @param uwb_rail ina23x of the UWB rail.
+ * @param mcu_rail ina23x of the MCU rail.
+ *
+ * @retval 0 If successful.
+ * @retval -output error number.
+ */
+int energy_profiler_init(struct ina23x_data *uwb_rail, struct ina23x_data *mcu_rail){
+	struct ina23x_data *rails[ENERGY_EVENT_COUNT] = {
+		[ENERGY_EVENT_UWB] = uwb_rail,
+		[ENERGY_EVENT_BLE] = mcu_rail,
+	};
+	int err = 0;
+
+	for (int i = 0; i < ENERGY_EVENT_COUNT; i++){
+		atomic_set(&windows[i].state, WINDOW_IDLE);
+		err += ina23x_write(rails[i], INA23X_CONFIG, INA231_CONFIG_FAST);
+		// The sampler never reads Mask/Enable, a conversion ready alert
+		// would hold the shared ALERT line asserted
+		err += ina23x_write(rails[i], INA231_MASK_ENABLE, 0);
+	}
+
+	if (err){
+		printk("Energy profiler: failed to configure the ina231\n");
+		return -EIO;
+	}
+
+	IRQ_CONNECT(RADIO_NOTIFICATION_IRQn, RADIO_NOTIFICATION_PRIO, radio_notification_isr, NULL, 0);
+	irq_enable(RADIO_NOTIFICATION_IRQn);
+	// 200 us ahead so the window covers the radio ramp up, the idle part is subtracted
+	if (mpsl_radio_notification_cfg_set(MPSL_RADIO_NOTIFICATION_TYPE_INT_ON_BOTH,
+		MPSL_RADIO_NOTIFICATION_DISTANCE_200US, RADIO_NOTIFICATION_IRQn)){
+		printk("Energy profiler: radio notification setup failed, BLE is not profiled\n");
+		rails[ENERGY_EVENT_BLE] = NULL;
+	}
+
+	// The windows can be opened from now on, the tasks may already be running.
+	// Without BLE profiling the MCU rail goes back to the telemetry.
+	for (int i = 0; i < ENERGY_EVENT_COUNT; i++){
+		windows[i].rail = rails[i];
+	}
+	printk("Energy profiler enabled on ina@%x (UWB) and ina@%x (BLE)\n",
+		uwb_rail->devSpec.addr, mcu_rail->devSpec.addr);
+
+	return 0;
+}
+
+/** @brief Check if a rail is reserved by the profiler.
+ *
+ * @param rail ina23x to check.
+ *
+ * @return TRUE if the rail must not be used by anyone else.
+ */
+bool energy_profiler_owns(const struct ina23x_data *rail){
+	for (int i = 0; i < ENERGY_EVENT_COUNT; i++){
+		if (windows[i].rail == rail){
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/** @brief Open the measurement window of an event.
+ *
+ * @param ev Event about to start.
+ *
+ * @return TRUE if the window is open and energy_profiler_end() must be called.
+ */
+bool energy_profiler_begin(enum energy_event ev){
+	struct energy_window *w = &windows[ev];
+
+	if (!w->rail || atomic_get(&w->state) != WINDOW_IDLE){
+		return false;
+	}
+
+	window_reset(w, timebase_now_us());
+	atomic_set(&w->state, WINDOW_OPEN);
+	k_sem_give(&sampler_wake);
+
+	return true;
+}
+
+/** @brief Close the measurement window of an event.
+ *
+ * Its net energy is recorded by the sampler thread.
+ *
+ * @param ev Event that ended.
+ * @param units Number of units of the event: UWB IRQs or BLE frames sent.
+ * @param bytes Number of payload bytes sent or received during the event.
+ */
+void energy_profiler_end(enum energy_event ev, uint32_t units, uint32_t bytes){
+	struct energy_window *w = &windows[ev];
+
+	if (atomic_get(&w->state) != WINDOW_OPEN){
+		return;
+	}
+
+	w->pending_units = units;
+	w->pending_bytes = bytes;
+	w->end_us = timebase_now_us();
+	atomic_set(&w->state, WINDOW_CLOSING);
+	k_sem_give(&sampler_wake);
+}
+
+/** @brief Measure the next radio event, which sends the queued notifications.
+ *
+ * Frames armed again before the radio event are added to it. Frames armed
+ * while the window is busy are not measured.
+ *
+ * @param ev Radio event, ENERGY_EVENT_BLE.
+ * @param units Number of frames queued.
+ * @param bytes Number of payload bytes queued.
+ */
+void energy_profiler_arm(enum energy_event ev, uint32_t units, uint32_t bytes){
+	struct energy_window *w = &windows[ev];
+	unsigned int key;
+
+	if (!w->rail || !units){
+		return;
+	}
+
+	// The radio notification interrupt opens the window
+	key = irq_lock();
+	switch (atomic_get(&w->state)){
+	case WINDOW_IDLE:
+		w->pending_units = units;
+		w->pending_bytes = bytes;
+		atomic_set(&w->state, WINDOW_ARMED);
+		break;
+	case WINDOW_ARMED:
+		w->pending_units += units;
+		w->pending_bytes += bytes;
+		break;
+	default:
+		break;
+	}
+	irq_unlock(key);
+}
+
+/** @brief Print the energy statistics of every event.
+ *
+ * Energies are net of the idle power of the rail.
+ */
+void energy_profiler_report(void){
+	for (int i = 0; i < ENERGY_EVENT_COUNT; i++){
+		const struct energy_window *w = &windows[i];
+		uint64_t total_nJ = w->total_pJ / 1000;
+
+		if (!w->events){
+			printk("%s energy: no event\n", event_names[i]);
+			continue;
+		}
+
+		printk("%s energy (net of idle %u uW, %u baselines, %u dropped): %u events (%u without %s, %u before baseline)"
+			" || %u.%03u uJ total || %u samples/event || %u read errors\n",
+			event_names[i], w->idle_uW, w->baselines, w->void_baselines, w->events, w->idle_events,
+			unit_names[i], w->unbaselined,
+			(uint32_t)(total_nJ / 1000), (uint32_t)(total_nJ % 1000),
+			(uint32_t)(w->total_samples / w->events), w->read_errors);
+		if (w->units){
+			uint32_t per_unit_nJ = (uint32_t)(w->units_pJ / 1000 / w->units);
+
+			printk("  avg %u.%03u uJ/%s over %u %ss\n", per_unit_nJ / 1000, per_unit_nJ % 1000,
+				unit_names[i], w->units, unit_names[i]);
+			hist_print(unit_names[i], w->hist_unit, CONFIG_APP_ENERGY_PROFILER_FRAME_BIN_NJ);
+		}
+		if (w->bytes){
+			uint32_t per_byte_nJ = (uint32_t)(w->bytes_pJ / 1000 / w->bytes);
+
+			printk("  avg %u.%03u uJ/byte over %u bytes\n",
+				per_byte_nJ / 1000, per_byte_nJ % 1000, w->bytes);
+			hist_print("byte", w->hist_byte, CONFIG_APP_ENERGY_PROFILER_BYTE_BIN_NJ);
+		}
+	}
+}
@@ -0,0 +1,47 @@
+/** @file       energy_profiler.h
+ *  @brief      Energy attribution of the UWB and BLE events.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+#ifndef ENERGY_PROFILER_H_
+#define ENERGY_PROFILER_H_
+
+/* INCLUDES *******************************************************************/
+#include <zephyr/kernel.h>
+#include "INA231.h"
+
+/* Profiled activities. Each one is measured on its own rail. */
+enum energy_event {
+	ENERGY_EVENT_UWB,	/* UWB rail */
+	ENERGY_EVENT_BLE,	/* MCU rail, the BLE radio is in the nRF52840 */
+	ENERGY_EVENT_COUNT
+};
+
+/* PUBLIC FUNCTION PROTOTYPES *************************************************/
+#if defined(CONFIG_APP_ENERGY_PROFILER)
+int energy_profiler_init(struct ina23x_data *uwb_rail, struct ina23x_data *mcu_rail);
+bool energy_profiler_owns(const struct ina23x_data *rail);
+bool energy_profiler_begin(enum energy_event ev);
+void energy_profiler_end(enum energy_event ev, uint32_t units, uint32_t bytes);
+void energy_profiler_arm(enum energy_event ev, uint32_t units, uint32_t bytes);
+void energy_profiler_report(void);
+#else
+static inline int energy_profiler_init(struct ina23x_data *uwb_rail, struct ina23x_data *mcu_rail){
+	return 0;
+}
+static inline bool energy_profiler_owns(const struct ina23x_data *rail){
+	return false;
+}
+static inline bool energy_profiler_begin(enum energy_event ev){
+	return false;
+}
+static inline void energy_profiler_end(enum energy_event ev, uint32_t units, uint32_t bytes){
+}
+static inline void energy_profiler_arm(enum energy_event ev, uint32_t units, uint32_t bytes){
+}
+static inline void energy_profiler_report(void){
+}
+#endif
+
+#endif /* ENERGY_PROFILER_H_ */
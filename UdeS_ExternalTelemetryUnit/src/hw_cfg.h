@@ -12,6 +12,7 @@
 #include <zephyr/drivers/spi.h>
 #include <zephyr/device.h>
 #include <zephyr/sys/printk.h>
+#include <soc.h>
 // Bluetooth HEADER files
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/hci.h>
@@ -63,6 +64,14 @@ static const struct gpio_dt_spec uwb_reset_pin      = GPIO_DT_SPEC_GET(UWB_RESET
 /* GPIOs spec structure containing the configuration. */
 /* To use with function named : gpio_pin_XXX_dt() */
 static const struct gpio_dt_spec uwb_irq_pin    = GPIO_DT_SPEC_GET(UWB_IRQ_NODE, gpios);
+#define UWB_IRQ_PSEL    NRF_DT_GPIOS_TO_PSEL(UWB_IRQ_NODE, gpios)
+
+/* Optional ALERT line of the ina231, timestamped when present in the devicetree */
+#define INA_ALERT_NODE DT_ALIAS(ina_alert)
+#if DT_NODE_EXISTS(INA_ALERT_NODE)
+static const struct gpio_dt_spec ina_alert_pin  = GPIO_DT_SPEC_GET(INA_ALERT_NODE, gpios);
+#define INA_ALERT_PSEL  NRF_DT_GPIOS_TO_PSEL(INA_ALERT_NODE, gpios)
+#endif
 
 /* *********************************************** */
 
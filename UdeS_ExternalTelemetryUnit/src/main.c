@@ -15,18 +15,85 @@
 #include "hw_cfg.h"
 #include "INA231.h"
 #include "usb_console.h"
+#include "task_monitor.h"
+#include "telemetry.h"
+#include "mem_report.h"
+#include "timebase.h"
+#include "energy_profiler.h"
+#include "transient_capture.h"
+#include "boot_time.h"
 
 /* Private function prototype ************************************************/
 
 /* INA I2C DEVICES ************************************************************/
-static const struct i2c_dt_spec dev_ina_MCU = I2C_DT_SPEC_GET(DT_NODELABEL(ina_mcu));
-static const struct i2c_dt_spec dev_ina_UWB = I2C_DT_SPEC_GET(DT_NODELABEL(ina_uwb));
-static const struct i2c_dt_spec dev_ina_uSD = I2C_DT_SPEC_GET(DT_NODELABEL(ina_usd));
-static const struct i2c_dt_spec dev_ina_5V = I2C_DT_SPEC_GET(DT_NODELABEL(ina_5v));
-
-void show_data_ina23x(struct ina23x_data *ina1);
+static struct ina23x_data ina_MCU = {I2C_DT_SPEC_GET(DT_NODELABEL(ina_mcu))};
+static struct ina23x_data ina_UWB = {I2C_DT_SPEC_GET(DT_NODELABEL(ina_uwb))};
+static struct ina23x_data ina_uSD = {I2C_DT_SPEC_GET(DT_NODELABEL(ina_usd))};
+static struct ina23x_data ina_5V = {I2C_DT_SPEC_GET(DT_NODELABEL(ina_5v))};
+
+static struct ina23x_data *const ina_rails[] = {&ina_MCU, &ina_UWB, &ina_uSD, &ina_5V};
+
+#if defined(CONFIG_APP_TRANSIENT_CAPTURE_RAIL_MCU)
+#define INA_CAPTURE_RAIL	(&ina_MCU)
+#elif defined(CONFIG_APP_TRANSIENT_CAPTURE_RAIL_UWB)
+#define INA_CAPTURE_RAIL	(&ina_UWB)
+#elif defined(CONFIG_APP_TRANSIENT_CAPTURE_RAIL_USD)
+#define INA_CAPTURE_RAIL	(&ina_uSD)
+#elif defined(CONFIG_APP_TRANSIENT_CAPTURE_RAIL_5V)
+#define INA_CAPTURE_RAIL	(&ina_5V)
+#endif
+
+#define INA_RAIL_COUNT ARRAY_SIZE(ina_rails)
+BUILD_ASSERT(ARRAY_SIZE(ina_rails) == TELEMETRY_RAIL_COUNT);
+
+/* INA231_CONFIG_DEFAULT converts in 16 x (1.1 ms + 1.1 ms) = 35.2 ms */
+#define INA_CONVERSION_TIMEOUT_MS	50
+#define INA_CONVERSION_POLL			K_MSEC(1)
+
+uint32_t wait_conversion_ina23x(struct telemetry_frame *frame, uint32_t pending);
+void read_ina23x(struct ina23x_data *ina1, struct ina23x_sample *sample);
+void show_data_ina23x(const struct ina23x_sample *sample);
 void init_all_ina23x(struct ina23x_data *ina1,struct ina23x_data *ina2,
 	struct ina23x_data *ina3,struct ina23x_data *ina4);
+bool ina_rail_reserved(const struct ina23x_data *ina1);
+
+/* BOOT ***********************************************************************/
+#define BOOT_LED_STEPS		4
+#define BOOT_LED_STEP_MS	500
+
+static void init_power_monitors(void);
+static void boot_led_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(boot_led_work, boot_led_work_handler);
+
+/* TASKS **********************************************************************/
+static void uwb_task(void *p1, void *p2, void *p3);
+static void sensor_task(void *p1, void *p2, void *p3);
+static void ble_task(void *p1, void *p2, void *p3);
+static void console_task(void *p1, void *p2, void *p3);
+
+static struct task_monitor uwb_mon = TASK_MONITOR_INIT("UWB",
+	CONFIG_APP_UWB_TASK_PERIOD_MS, CONFIG_APP_UWB_TASK_DEADLINE_MS);
+static struct task_monitor sensor_mon = TASK_MONITOR_INIT("Sensor",
+	CONFIG_APP_SENSOR_TASK_PERIOD_MS, CONFIG_APP_SENSOR_TASK_DEADLINE_MS);
+static struct task_monitor ble_mon = TASK_MONITOR_INIT("BLE",
+	CONFIG_APP_BLE_TASK_PERIOD_MS, CONFIG_APP_BLE_TASK_DEADLINE_MS);
+static struct task_monitor console_mon = TASK_MONITOR_INIT("Console",
+	CONFIG_APP_CONSOLE_TASK_PERIOD_MS, CONFIG_APP_CONSOLE_TASK_DEADLINE_MS);
+
+static const struct task_monitor *const task_monitors[] = {
+	&uwb_mon, &sensor_mon, &ble_mon, &console_mon
+};
+
+/* Threads are created suspended and started by main() and bt_ready_cb() */
+K_THREAD_DEFINE(uwb_tid, CONFIG_APP_UWB_TASK_STACK_SIZE, uwb_task, NULL, NULL, NULL,
+	CONFIG_APP_UWB_TASK_PRIORITY, 0, SYS_FOREVER_MS);
+K_THREAD_DEFINE(sensor_tid, CONFIG_APP_SENSOR_TASK_STACK_SIZE, sensor_task, NULL, NULL, NULL,
+	CONFIG_APP_SENSOR_TASK_PRIORITY, 0, SYS_FOREVER_MS);
+K_THREAD_DEFINE(ble_tid, CONFIG_APP_BLE_TASK_STACK_SIZE, ble_task, NULL, NULL, NULL,
+	CONFIG_APP_BLE_TASK_PRIORITY, 0, SYS_FOREVER_MS);
+K_THREAD_DEFINE(console_tid, CONFIG_APP_CONSOLE_TASK_STACK_SIZE, console_task, NULL, NULL, NULL,
+	CONFIG_APP_CONSOLE_TASK_PRIORITY, 0, SYS_FOREVER_MS);
 
 
 /* BLE related prototype ****************************************************************/
@@ -41,30 +108,32 @@ static const struct bt_data ad[] = {
 static void connected(struct bt_conn *conn, uint8_t err);
 static void disconnected(struct bt_conn *conn, uint8_t reason);
 
+static struct bt_conn *ble_conn;
+/* Notified characteristic values, found once Bluetooth is ready */
+static const struct bt_gatt_attr *hrs_measurement_attr;
+static const struct bt_gatt_attr *bas_level_attr;
+
 BT_CONN_CB_DEFINE(conn_callbacks) = {
 	.connected = connected,
 	.disconnected = disconnected,
 };
 
 static void bt_ready(void);
+static void bt_ready_cb(int err);
 static void auth_cancel(struct bt_conn *conn);
 
 static struct bt_conn_auth_cb auth_cb_display = {
 	.cancel = auth_cancel,
 };
 
-static void bas_notify(void);
-static void hrs_notify(void);
+static int bas_notify(void);
+static int hrs_notify(void);
+static bool ble_subscribed(const struct bt_gatt_attr *attr);
 /* END of BLE realted prototype *********************************************************/
 
 int main(void)
 {
 	uint32_t err;
-	uint32_t led_status = 0;
-	struct ina23x_data ina_MCU = {dev_ina_MCU};
-	struct ina23x_data ina_UWB = {dev_ina_UWB};
-	struct ina23x_data ina_uSD = {dev_ina_uSD};
-	struct ina23x_data ina_5V = {dev_ina_5V};
 	if (!gpio_is_ready_dt(&led0) & !gpio_is_ready_dt(&led1) & !gpio_is_ready_dt(&led2) & !gpio_is_ready_dt(&led3) & !gpio_is_ready_dt(&led4) & !gpio_is_ready_dt(&uwb_irq_pin))
 	{
 		return 0;
@@ -76,6 +145,7 @@ int main(void)
 	gpio_pin_configure_dt(&led3, GPIO_OUTPUT_INACTIVE);
 	gpio_pin_configure_dt(&led4, GPIO_OUTPUT_INACTIVE);
 
+	boot_phase_begin(BOOT_PHASE_CONSOLE);
 	err = enable_usb_console();
 	if (err)
 	{
@@ -89,53 +159,250 @@ int main(void)
 		printk("LEDs init allo failed (err %d)\n", err);
 		return 0;
 	}
-	// Initializing all ina231 before use and power down them.
-	init_all_ina23x(&ina_MCU, &ina_UWB, &ina_uSD, &ina_5V);
-
-	iface_tx_conn_status();
-    iface_delay(500);
-    iface_rx_conn_status();
-    iface_delay(500);
-    iface_rx_conn_status();
-    iface_delay(500);
-    iface_tx_conn_status();
+	boot_phase_end(BOOT_PHASE_CONSOLE);
 
-	init_cortical_implant();
+	timebase_init();
 
 	/* BLE code *******************************************/
+	// The controller comes up in the background, bt_ready_cb() finishes the init
 	printk("Starting Bluetooth Peripheral HR coded example\n");
-	err = bt_enable(NULL);
+	boot_phase_begin(BOOT_PHASE_BT);
+	err = bt_enable(bt_ready_cb);
 	if (err) {
 		printk("Bluetooth init failed (err %d)\n", err);
 		return 0;
 	}
 
-	bt_ready();
-
 	//bt_conn_auth_cb_register(&auth_cb_display);
 	/*******************************************************/
 
+	// The sensor task initializes the ina231 while the UWB comes up
+	k_thread_start(sensor_tid);
+
+	// Connection status sequence runs in the background instead of blocking 1.5 s
+	k_work_schedule(&boot_led_work, K_NO_WAIT);
+
+	boot_phase_begin(BOOT_PHASE_UWB);
+	init_cortical_implant();
+	boot_phase_end(BOOT_PHASE_UWB);
+
+	// UWB IRQ is configured by the cortical implant init, timestamp it from now on
+	timebase_capture_enable(TIMEBASE_SRC_UWB_IRQ, &uwb_irq_pin, UWB_IRQ_PSEL);
+#if DT_NODE_EXISTS(INA_ALERT_NODE)
+	gpio_pin_configure_dt(&ina_alert_pin, GPIO_INPUT);
+	gpio_pin_interrupt_configure_dt(&ina_alert_pin, GPIO_INT_EDGE_TO_ACTIVE);
+	timebase_capture_enable(TIMEBASE_SRC_INA_ALERT, &ina_alert_pin, INA_ALERT_PSEL);
+#endif
+
+	k_thread_start(uwb_tid);
+	k_thread_start(console_tid);
+
+	return 0;
+}
+
+/* Boot ***********************************************************************/
+static void init_power_monitors(void)
+{
+	// Initializing all ina231 before use and power down them.
+	init_all_ina23x(&ina_MCU, &ina_UWB, &ina_uSD, &ina_5V);
+	energy_profiler_init(&ina_UWB, &ina_MCU);
+#if defined(CONFIG_APP_TRANSIENT_CAPTURE)
+	if (energy_profiler_owns(INA_CAPTURE_RAIL)){
+		printk("Transient capture disabled, ina@%x is used by the energy profiler\n",
+			INA_CAPTURE_RAIL->devSpec.addr);
+	}else{
+		transient_capture_init(INA_CAPTURE_RAIL, CONFIG_APP_TRANSIENT_CAPTURE_THRESHOLD_UA);
+	}
+#endif
+}
+
+static void boot_led_work_handler(struct k_work *work)
+{
+	static int step;
+
+	switch (step) {
+	case 0:
+	case 3:
+		iface_tx_conn_status();
+		break;
+	case 1:
+	case 2:
+		iface_rx_conn_status();
+		break;
+	default:
+		return;
+	}
+
+	if (++step < BOOT_LED_STEPS) {
+		k_work_schedule(k_work_delayable_from_work(work), K_MSEC(BOOT_LED_STEP_MS));
+	}
+}
+
+/* Tasks **********************************************************************/
+static void uwb_task(void *p1, void *p2, void *p3)
+{
+	uint32_t uwb_irqs;
+
+	task_monitor_start(&uwb_mon);
+	for (;;)
+	{
+		task_monitor_job_begin(&uwb_mon);
+		if (energy_profiler_begin(ENERGY_EVENT_UWB)){
+			// The SDK gives no TX/RX completion, the energy is per UWB IRQ edge
+			uwb_irqs = timebase_event_count(TIMEBASE_SRC_UWB_IRQ);
+			cortical_implant_routine();
+			energy_profiler_end(ENERGY_EVENT_UWB,
+				timebase_event_count(TIMEBASE_SRC_UWB_IRQ) - uwb_irqs, 0);
+		}else{
+			cortical_implant_routine();
+		}
+		unpair_device();
+		task_monitor_job_end(&uwb_mon);
+		task_monitor_wait(&uwb_mon);
+	}
+}
+
+static void sensor_task(void *p1, void *p2, void *p3)
+{
+	struct telemetry_frame *frame;
+	uint32_t seq = 0;
+	uint32_t powered;
+	uint32_t ready;
+
+	boot_phase_begin(BOOT_PHASE_INA);
+	init_power_monitors();
+	boot_phase_end(BOOT_PHASE_INA);
+
+	task_monitor_start(&sensor_mon);
 	for (;;)
 	{
-		cortical_implant_routine();
+		task_monitor_job_begin(&sensor_mon);
+
+		frame = telemetry_frame_alloc();
+		if (!frame){
+			printk("No telemetry frame available\n");
+			task_monitor_job_end(&sensor_mon);
+			task_monitor_wait(&sensor_mon);
+			continue;
+		}
+		frame->seq = seq++;
+
+		// Power up every rail first so their conversions run in parallel,
+		// then wait for all of them. Rails reserved by a profiling mode are left alone.
+		powered = 0;
+		for (int i = 0; i < INA_RAIL_COUNT; i++){
+			if (!ina_rail_reserved(ina_rails[i]) && ina23x_power_up(ina_rails[i])){
+				powered |= BIT(i);
+			}
+		}
+		ready = wait_conversion_ina23x(frame, powered);
+		for (int i = 0; i < INA_RAIL_COUNT; i++){
+			frame->rails[i].addr = ina_rails[i]->devSpec.addr;
+			if (ina_rail_reserved(ina_rails[i])){
+				frame->rails[i].err = -EBUSY;
+			}else if (!(powered & BIT(i))){
+				frame->rails[i].err = -EIO;
+			}else if (!(ready & BIT(i))){
+				frame->rails[i].err = -ETIMEDOUT;
+			}else{
+				read_ina23x(ina_rails[i], &frame->rails[i]);
+			}
+		}
+		// Power down after reading to save energy
+		for (int i = 0; i < INA_RAIL_COUNT; i++){
+			if (!ina_rail_reserved(ina_rails[i])){
+				ina23x_power_down(ina_rails[i]);
+			}
+		}
 
-		printk(GRN"***********************************************************************************\n");
-		show_data_ina23x(&ina_MCU);
-		show_data_ina23x(&ina_UWB);
-		show_data_ina23x(&ina_uSD);
-		show_data_ina23x(&ina_5V);
-		printk(GRN"***********************************************************************************\n"NRM);
+		telemetry_frame_send(frame);
+		boot_first_sample();
 
+		task_monitor_job_end(&sensor_mon);
+		task_monitor_wait(&sensor_mon);
+	}
+}
+
+static void ble_task(void *p1, void *p2, void *p3)
+{
+	uint32_t frames;
+	uint32_t bytes;
+
+	task_monitor_start(&ble_mon);
+	for (;;)
+	{
+		task_monitor_job_begin(&ble_mon);
+		frames = 0;
+		bytes = 0;
 		/* Heartrate measurements simulation */
-		hrs_notify();
+		// The services return 0 when no peer is subscribed, only count sent frames
+		if (!hrs_notify() && ble_subscribed(hrs_measurement_attr)){
+			frames++;
+			bytes += 2;		// Flags and 8-bit heart rate
+		}
 		/* Battery level simulation */
-		bas_notify();
-
-		unpair_device();
-		k_sleep(K_MSEC(100));
+		if (!bas_notify() && ble_subscribed(bas_level_attr)){
+			frames++;
+			bytes += 1;		// Battery level
+		}
+		// The notifications are sent at the next connection event, measure its radio activity
+		energy_profiler_arm(ENERGY_EVENT_BLE, frames, bytes);
+		task_monitor_job_end(&ble_mon);
+		task_monitor_wait(&ble_mon);
 	}
+}
 
-	return 0;
+static void console_task(void *p1, void *p2, void *p3)
+{
+	struct telemetry_frame *frame;
+	int64_t last_report = k_uptime_get();
+
+	task_monitor_start(&console_mon);
+	for (;;)
+	{
+		task_monitor_job_begin(&console_mon);
+
+		boot_time_report();
+		if (transient_capture_dump()){
+			// Frames wait in the queue and reports are delayed until the dump ends
+			task_monitor_job_end(&console_mon);
+			task_monitor_wait(&console_mon);
+			continue;
+		}
+
+		while ((frame = telemetry_frame_receive(K_NO_WAIT)) != NULL){
+			printk(GRN"***********************************************************************************\n");
+			for (int i = 0; i < INA_RAIL_COUNT; i++){
+				show_data_ina23x(&frame->rails[i]);
+			}
+			printk(GRN"***********************************************************************************\n"NRM);
+			telemetry_frame_free(frame);
+		}
+
+		if (CONFIG_APP_TASK_REPORT_INTERVAL_MS &&
+			k_uptime_get() - last_report >= CONFIG_APP_TASK_REPORT_INTERVAL_MS){
+			last_report = k_uptime_get();
+			printk(CYN"Task statistics\n"NRM);
+			for (int i = 0; i < ARRAY_SIZE(task_monitors); i++){
+				task_monitor_report(task_monitors[i]);
+			}
+			printk(CYN"Timebase\n"NRM);
+			timebase_report();
+			if (IS_ENABLED(CONFIG_APP_ENERGY_PROFILER)){
+				printk(CYN"Energy\n"NRM);
+				energy_profiler_report();
+			}
+			printk(CYN"Memory usage\n"NRM);
+			telemetry_report();
+			if (IS_ENABLED(CONFIG_APP_MEM_REPORT)){
+				mem_report_heap();
+				mem_report_stacks();
+			}
+		}
+
+		task_monitor_job_end(&console_mon);
+		task_monitor_wait(&console_mon);
+	}
 }
 
 /* Private function ***********************************************************/
@@ -190,47 +457,88 @@ void init_all_ina23x(struct ina23x_data *ina1,struct ina23x_data *ina2,
 	}
 }
 
-void show_data_ina23x(struct ina23x_data *ina1){
-	int err = 0;
-	int tempCurrent = 0;
-	int tempBus = 0;
-	int tempPower = 0;
-
-	// Power up before reading
-	ina23x_power_up(ina1);
-
-	// Read current, Bus voltage and power and print the values
-	err += ina23x_format_read(ina1,INA23X_CURRENT,&tempCurrent);
-	err += ina23x_format_read(ina1,INA23X_POWER,&tempPower);
-	err += ina23x_format_read(ina1,INA23X_BUS_VOLTAGE,&tempBus);
-
-	if(err){
-		printk("Error showing the data (ina@%x)", ina1->devSpec.addr);
-		// Power down to save energy
-		ina23x_power_down(ina1);
-	}else{
-		switch(ina1->devSpec.addr){
-		case 0x40:
-			printk(GRN"ina@MCU : "NRM);
-			break;
-		case 0x41:
-			printk(GRN"ina@UWB : "NRM);
-			break;
-		case 0x44:
-			printk(GRN"ina@uSD : "NRM);
-			break;
-		case 0x45:
-			printk(GRN"ina@5V  : "NRM);
+bool ina_rail_reserved(const struct ina23x_data *ina1){
+	return energy_profiler_owns(ina1) || transient_capture_owns(ina1);
+}
+
+/* Wait for a conversion started after the power up of each pending rail.
+ * The sample of a rail is stamped when its conversion ready flag is seen,
+ * so the timestamp marks the end of the averaging window within one poll.
+ * Returns the rails whose conversion is ready. */
+uint32_t wait_conversion_ina23x(struct telemetry_frame *frame, uint32_t pending){
+	int64_t timeout = k_uptime_get() + INA_CONVERSION_TIMEOUT_MS;
+	uint32_t ready = 0;
+
+	while (pending){
+		for (int i = 0; i < INA_RAIL_COUNT; i++){
+			// Reading the flag clears it, the registers keep this conversion
+			if ((pending & BIT(i)) && ina23x_conversion_ready(ina_rails[i])){
+				frame->rails[i].timestamp_us = timebase_now_us();
+				pending &= ~BIT(i);
+				ready |= BIT(i);
+			}
+		}
+		if (!pending){
 			break;
-		default:
-			printk(YEL"ina@%x : "NRM, ina1->devSpec.addr);
+		}
+		if (k_uptime_get() >= timeout){
+			printk("ina231 conversion timeout (rails 0x%x)\n", pending);
 			break;
 		}
-		printk("Bus voltage = %i mV || Current = %i uA \t|| Power = %i uW\n", tempBus, tempCurrent, tempPower);
+		k_sleep(INA_CONVERSION_POLL);
+	}
+
+	return ready;
+}
+
+void read_ina23x(struct ina23x_data *ina1, struct ina23x_sample *sample){
+	uint16_t raw[3] = {0};
+	int err = 0;
+
+	// Read current, Bus voltage and power of the last conversion. The
+	// ina must be powered up and its conversion ready.
+	err += ina23x_read(ina1,INA23X_CURRENT,&raw[0]);
+	err += ina23x_read(ina1,INA23X_POWER,&raw[1]);
+	err += ina23x_read(ina1,INA23X_BUS_VOLTAGE,&raw[2]);
+	err += ina23x_format(ina1,INA23X_CURRENT,raw[0],&sample->current_uA);
+	err += ina23x_format(ina1,INA23X_POWER,raw[1],&sample->power_uW);
+	err += ina23x_format(ina1,INA23X_BUS_VOLTAGE,raw[2],&sample->bus_mV);
+
+	sample->err = err;
+}
+
+void show_data_ina23x(const struct ina23x_sample *sample){
+	if(sample->err == -EBUSY){
+		printk("ina@%x reserved by a profiling mode\n", sample->addr);
+		return;
+	}else if(sample->err == -ETIMEDOUT){
+		printk("ina@%x conversion not ready\n", sample->addr);
+		return;
+	}else if(sample->err){
+		printk("Error showing the data (ina@%x)\n", sample->addr);
+		return;
 	}
 
-	// Power down after reading to save energy
-	ina23x_power_down(ina1);
+	switch(sample->addr){
+	case 0x40:
+		printk(GRN"ina@MCU : "NRM);
+		break;
+	case 0x41:
+		printk(GRN"ina@UWB : "NRM);
+		break;
+	case 0x44:
+		printk(GRN"ina@uSD : "NRM);
+		break;
+	case 0x45:
+		printk(GRN"ina@5V  : "NRM);
+		break;
+	default:
+		printk(YEL"ina@%x : "NRM, sample->addr);
+		break;
+	}
+	printk("t = %u.%03u ms || Bus voltage = %i mV || Current = %i uA \t|| Power = %i uW\n",
+		(uint32_t)(sample->timestamp_us / 1000), (uint32_t)(sample->timestamp_us % 1000),
+		sample->bus_mV, sample->current_uA, sample->power_uW);
 }
 
 /* Bluetooth related functions *************************************************/
@@ -241,12 +549,19 @@ static void connected(struct bt_conn *conn, uint8_t err)
 		printk("Connection failed (err 0x%02x)\n", err);
 	} else {
 		printk("Connected\n");
+		ble_conn = bt_conn_ref(conn);
 	}
 }
 
 static void disconnected(struct bt_conn *conn, uint8_t reason)
 {
+	struct bt_conn *old_conn = ble_conn;
+
 	printk("Disconnected (reason 0x%02x)\n", reason);
+	ble_conn = NULL;
+	if (old_conn) {
+		bt_conn_unref(old_conn);
+	}
 }
 
 static void bt_ready(void)
@@ -255,6 +570,9 @@ static void bt_ready(void)
 
 	printk("Bluetooth initialized\n");
 
+	hrs_measurement_attr = bt_gatt_find_by_uuid(NULL, 0, BT_UUID_HRS_MEASUREMENT);
+	bas_level_attr = bt_gatt_find_by_uuid(NULL, 0, BT_UUID_BAS_BATTERY_LEVEL);
+
 	err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
 	if (err) {
 		printk("Advertising failed to start (err %d)\n", err);
@@ -264,6 +582,18 @@ static void bt_ready(void)
 	printk("Advertising successfully started\n");
 }
 
+static void bt_ready_cb(int err)
+{
+	boot_phase_end(BOOT_PHASE_BT);
+	if (err) {
+		printk("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	bt_ready();
+	k_thread_start(ble_tid);
+}
+
 static void auth_cancel(struct bt_conn *conn)
 {
 	char addr[BT_ADDR_LE_STR_LEN];
@@ -273,7 +603,7 @@ static void auth_cancel(struct bt_conn *conn)
 	printk("Pairing cancelled: %s\n", addr);
 }
 
-static void bas_notify(void)
+static int bas_notify(void)
 {
 	uint8_t battery_level = bt_bas_get_battery_level();
 
@@ -283,10 +613,10 @@ static void bas_notify(void)
 		battery_level = 100U;
 	}
 
-	bt_bas_set_battery_level(battery_level);
+	return bt_bas_set_battery_level(battery_level);
 }
 
-static void hrs_notify(void)
+static int hrs_notify(void)
 {
 	static uint8_t heartrate = 90U;
 
@@ -296,5 +626,12 @@ static void hrs_notify(void)
 		heartrate = 90U;
 	}
 
-	bt_hrs_notify(heartrate);
-}
\ No newline at end of file
+	return bt_hrs_notify(heartrate);
+}
+
+static bool ble_subscribed(const struct bt_gatt_attr *attr)
+{
+	struct bt_conn *conn = ble_conn;
+
+	return conn && attr && bt_gatt_is_subscribed(conn, attr, BT_GATT_CCC_NOTIFY);
+}
@@ -0,0 +1,78 @@
+/** @file       mem_report.c
+ *  @brief      Runtime report of the heap and thread stack usage.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+/* INCLUDES *******************************************************************/
+#include "mem_report.h"
+#include <zephyr/sys/sys_heap.h>
+
+/* Newer kernels size the system heap with the subsystem requests added */
+#if defined(K_HEAP_MEM_POOL_SIZE)
+#define SYSTEM_HEAP_SIZE	K_HEAP_MEM_POOL_SIZE
+#else
+#define SYSTEM_HEAP_SIZE	CONFIG_HEAP_MEM_POOL_SIZE
+#endif
+
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (SYSTEM_HEAP_SIZE > 0)
+/* Kernel heap backing k_malloc(), defined by the kernel */
+extern struct k_heap _system_heap;
+#endif
+
+/* PRIVATE FUNCTIONS **********************************************************/
+
+#if defined(CONFIG_THREAD_MONITOR) && defined(CONFIG_THREAD_STACK_INFO) && defined(CONFIG_INIT_STACKS)
+static void report_thread_stack(const struct k_thread *thread, void *user_data){
+	struct k_thread *t = (struct k_thread *)thread;
+	const char *name = k_thread_name_get(t);
+	size_t size = t->stack_info.size;
+	size_t unused = 0;
+
+	if (k_thread_stack_space_get(t, &unused)){
+		printk("  %-16s: stack usage unavailable\n", name ? name : "?");
+		return;
+	}
+
+	printk("  %-16s: %u/%u B used (%u%%)\n", name ? name : "?",
+		(unsigned int)(size - unused), (unsigned int)size,
+		(unsigned int)((size - unused) * 100 / size));
+}
+#endif
+
+/* PUBLIC FUNCTIONS ***********************************************************/
+
+/** @brief Print the current usage and the high-water mark of the kernel heap.
+ */
+void mem_report_heap(void){
+#if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (SYSTEM_HEAP_SIZE > 0)
+	struct sys_memory_stats stats;
+
+	if (sys_heap_runtime_stats_get(&_system_heap.heap, &stats)){
+		printk("Heap: statistics unavailable\n");
+		return;
+	}
+
+	// The capacity comes from the heap itself, it can exceed CONFIG_HEAP_MEM_POOL_SIZE
+	printk("Heap: %u B used || %u B free || high-water %u B of %u B\n",
+		(unsigned int)stats.allocated_bytes, (unsigned int)stats.free_bytes,
+		(unsigned int)stats.max_allocated_bytes,
+		(unsigned int)(stats.allocated_bytes + stats.free_bytes));
+#else
+	printk("Heap: statistics disabled\n");
+#endif
+}
+
+/** @brief Print the stack usage of every thread.
+ *
+ * Usage is found by scanning the stacks for the fill pattern written at
+ * thread creation, so it is the worst case since boot.
+ */
+void mem_report_stacks(void){
+#if defined(CONFIG_THREAD_MONITOR) && defined(CONFIG_THREAD_STACK_INFO) && defined(CONFIG_INIT_STACKS)
+	printk("Thread stacks:\n");
+	k_thread_foreach_unlocked(report_thread_stack, NULL);
+#else
+	printk("Thread stacks: statistics disabled\n");
+#endif
+}
@@ -0,0 +1,17 @@
+/** @file       mem_report.h
+ *  @brief      Runtime report of the heap and thread stack usage.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+#ifndef MEM_REPORT_H_
+#define MEM_REPORT_H_
+
+/* INCLUDES *******************************************************************/
+#include <zephyr/kernel.h>
+
+/* PUBLIC FUNCTION PROTOTYPES *************************************************/
+void mem_report_heap(void);
+void mem_report_stacks(void);
+
+#endif /* MEM_REPORT_H_ */
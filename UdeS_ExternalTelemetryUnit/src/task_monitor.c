@@ -0,0 +1,86 @@
+/** @file       task_monitor.c
+ *  @brief      Periodic task release and deadline monitoring.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+/* INCLUDES *******************************************************************/
+#include "task_monitor.h"
+
+/* PUBLIC FUNCTIONS ***********************************************************/
+
+/** @brief Set the first release of a periodic task to now.
+ *
+ * @param mon Monitor of the calling task.
+ */
+void task_monitor_start(struct task_monitor *mon){
+	mon->release = k_uptime_ticks();
+}
+
+/** @brief Mark the beginning of a job.
+ *
+ * @param mon Monitor of the calling task.
+ */
+void task_monitor_job_begin(struct task_monitor *mon){
+	mon->start = k_uptime_ticks();
+}
+
+/** @brief Mark the end of a job and check it against the task deadline.
+ *
+ * The response time is measured from the release, so time spent preempted
+ * by higher priority tasks counts against the deadline.
+ *
+ * @param mon Monitor of the calling task.
+ */
+void task_monitor_job_end(struct task_monitor *mon){
+	int64_t now = k_uptime_ticks();
+	uint32_t exec_us = k_ticks_to_us_floor32(now - mon->start);
+	uint32_t response_us = k_ticks_to_us_floor32(now - mon->release);
+
+	mon->runs++;
+	mon->last_us = exec_us;
+	if (exec_us > mon->max_us){
+		mon->max_us = exec_us;
+	}
+	if (response_us > mon->max_response_us){
+		mon->max_response_us = response_us;
+	}
+
+	if (response_us > mon->deadline_ms * USEC_PER_MSEC){
+		mon->misses++;
+		printk("%s task missed its deadline (%u us > %u ms)\n",
+			mon->name, response_us, mon->deadline_ms);
+	}
+}
+
+/** @brief Sleep until the next release of a periodic task.
+ *
+ * Releases are computed from the previous release and not from the end of
+ * the job so the period does not drift. If a job overran one or more whole
+ * periods, those releases are skipped instead of being run back to back.
+ *
+ * @param mon Monitor of the calling task.
+ */
+void task_monitor_wait(struct task_monitor *mon){
+	int64_t period = k_ms_to_ticks_ceil64(mon->period_ms);
+	int64_t now = k_uptime_ticks();
+
+	mon->release += period;
+	while (mon->release < now){
+		mon->release += period;
+		mon->skipped++;
+	}
+
+	k_sleep(K_TIMEOUT_ABS_TICKS(mon->release));
+}
+
+/** @brief Print the statistics of a task.
+ *
+ * @param mon Monitor of the task to report.
+ */
+void task_monitor_report(const struct task_monitor *mon){
+	printk("%-8s: period %u ms || runs %u || misses %u || skipped %u"
+		" || exec %u us (max %u us) || max response %u us\n",
+		mon->name, mon->period_ms, mon->runs, mon->misses, mon->skipped,
+		mon->last_us, mon->max_us, mon->max_response_us);
+}
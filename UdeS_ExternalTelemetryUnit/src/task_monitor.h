@@ -0,0 +1,41 @@
+/** @file       task_monitor.h
+ *  @brief      Periodic task release and deadline monitoring.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+#ifndef TASK_MONITOR_H_
+#define TASK_MONITOR_H_
+
+/* INCLUDES *******************************************************************/
+#include <zephyr/kernel.h>
+
+struct task_monitor {
+	const char *name;
+	uint32_t period_ms;
+	uint32_t deadline_ms;
+	int64_t release;        /* Release time of the current job in ticks */
+	int64_t start;          /* Start time of the current job in ticks */
+	uint32_t runs;
+	uint32_t misses;        /* Jobs ending after their deadline */
+	uint32_t skipped;       /* Releases dropped because a job overran its period */
+	uint32_t last_us;       /* Execution time of the last job */
+	uint32_t max_us;        /* Worst execution time seen */
+	uint32_t max_response_us; /* Worst release to end time seen */
+};
+
+#define TASK_MONITOR_INIT(_name, _period_ms, _deadline_ms) \
+	{                                                      \
+		.name = _name,                                     \
+		.period_ms = _period_ms,                           \
+		.deadline_ms = _deadline_ms,                       \
+	}
+
+/* PUBLIC FUNCTION PROTOTYPES *************************************************/
+void task_monitor_start(struct task_monitor *mon);
+void task_monitor_job_begin(struct task_monitor *mon);
+void task_monitor_job_end(struct task_monitor *mon);
+void task_monitor_wait(struct task_monitor *mon);
+void task_monitor_report(const struct task_monitor *mon);
+
+#endif /* TASK_MONITOR_H_ */
@@ -0,0 +1,93 @@
+/** @file       telemetry.c
+ *  @brief      Telemetry frames exchanged between the sensor and console tasks.
+ *
+ *  Frames live in a fixed-size memory slab sized by
+ *  CONFIG_APP_TELEMETRY_FRAME_COUNT and only their pointer goes through the
+ *  message queue, so no heap is used for telemetry.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+/* INCLUDES *******************************************************************/
+#include "telemetry.h"
+
+K_MEM_SLAB_DEFINE_STATIC(telemetry_slab, sizeof(struct telemetry_frame),
+	CONFIG_APP_TELEMETRY_FRAME_COUNT, __alignof__(struct telemetry_frame));
+/* Holds every frame of the slab, so a put never fails */
+static K_MSGQ_DEFINE(telemetry_msgq, sizeof(struct telemetry_frame *),
+	CONFIG_APP_TELEMETRY_FRAME_COUNT, 4);
+
+static uint32_t dropped;
+
+/* PUBLIC FUNCTIONS ***********************************************************/
+
+/** @brief Allocate a telemetry frame from the slab.
+ *
+ * When every frame is in use, the oldest frame still waiting in the queue
+ * is dropped and reused so the newest data is always kept.
+ *
+ * @return Pointer to the frame or NULL if every frame is held by a consumer.
+ */
+struct telemetry_frame *telemetry_frame_alloc(void){
+	struct telemetry_frame *frame = NULL;
+
+	if (k_mem_slab_alloc(&telemetry_slab, (void **)&frame, K_NO_WAIT)){
+		if (k_msgq_get(&telemetry_msgq, &frame, K_NO_WAIT)){
+			return NULL;
+		}
+		dropped++;
+	}
+
+	return frame;
+}
+
+/** @brief Give a telemetry frame back to the slab.
+ *
+ * @param frame Frame obtained from telemetry_frame_alloc() or
+ * telemetry_frame_receive().
+ */
+void telemetry_frame_free(struct telemetry_frame *frame){
+	k_mem_slab_free(&telemetry_slab, (void *)frame);
+}
+
+/** @brief Queue a frame for the consumer. Ownership goes to the queue.
+ *
+ * @param frame Frame obtained from telemetry_frame_alloc().
+ */
+void telemetry_frame_send(struct telemetry_frame *frame){
+	k_msgq_put(&telemetry_msgq, &frame, K_NO_WAIT);
+}
+
+/** @brief Get the oldest queued frame. Free it with telemetry_frame_free().
+ *
+ * @param timeout Time to wait for a frame.
+ *
+ * @return Pointer to the frame or NULL if none arrived before the timeout.
+ */
+struct telemetry_frame *telemetry_frame_receive(k_timeout_t timeout){
+	struct telemetry_frame *frame;
+
+	if (k_msgq_get(&telemetry_msgq, &frame, timeout)){
+		return NULL;
+	}
+
+	return frame;
+}
+
+/** @brief Number of frames dropped because the consumer was lagging.
+ */
+uint32_t telemetry_frames_dropped(void){
+	return dropped;
+}
+
+/** @brief Print the usage of the telemetry frame slab.
+ */
+void telemetry_report(void){
+	printk("Telemetry slab: %u/%u frames used",
+		k_mem_slab_num_used_get(&telemetry_slab), CONFIG_APP_TELEMETRY_FRAME_COUNT);
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)
+	printk(" (max %u)", k_mem_slab_max_used_get(&telemetry_slab));
+#endif
+	printk(" || %u B per frame || dropped %u\n", (unsigned int)sizeof(struct telemetry_frame),
+		telemetry_frames_dropped());
+}
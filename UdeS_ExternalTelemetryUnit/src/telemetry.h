@@ -0,0 +1,38 @@
+/** @file       telemetry.h
+ *  @brief      Telemetry frames exchanged between the sensor and console tasks.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/* INCLUDES *******************************************************************/
+#include <zephyr/kernel.h>
+
+/* Number of ina231 rails sampled in a frame (MCU, UWB, uSD and 5V) */
+#define TELEMETRY_RAIL_COUNT	4
+
+struct ina23x_sample {
+	uint64_t timestamp_us;	/* Timebase time the conversion was ready */
+	uint16_t addr;
+	int err;
+	int bus_mV;
+	int current_uA;
+	int power_uW;
+};
+
+struct telemetry_frame {
+	uint32_t seq;
+	struct ina23x_sample rails[TELEMETRY_RAIL_COUNT];
+};
+
+/* PUBLIC FUNCTION PROTOTYPES *************************************************/
+struct telemetry_frame *telemetry_frame_alloc(void);
+void telemetry_frame_free(struct telemetry_frame *frame);
+void telemetry_frame_send(struct telemetry_frame *frame);
+struct telemetry_frame *telemetry_frame_receive(k_timeout_t timeout);
+uint32_t telemetry_frames_dropped(void);
+void telemetry_report(void);
+
+#endif /* TELEMETRY_H_ */
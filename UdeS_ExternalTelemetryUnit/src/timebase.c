@@ -0,0 +1,222 @@
+/** @file       timebase.c
+ *  @brief      Microsecond timebase shared by the samples and the radio events.
+ *
+ *  TIMER2 runs freely at 1 MHz and is extended to 64 bits in software.
+ *  TIMER0 is left to the radio stacks. Event lines are timestamped in
+ *  hardware by routing their GPIOTE event to a TIMER2 capture task through
+ *  PPI. The capture is read back from the GPIO callback, so the interrupt
+ *  latency does not affect the timestamp.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+/* INCLUDES *******************************************************************/
+#include "timebase.h"
+#include <nrfx_timer.h>
+#include <nrfx_gpiote.h>
+#include <helpers/nrfx_gppi.h>
+
+/* CC0 is captured by timebase_now_us(), CC1 and up by the event sources */
+#define TIMEBASE_CC_NOW			NRF_TIMER_CC_CHANNEL0
+#define TIMEBASE_CC_SRC(src)	((nrf_timer_cc_channel_t)(NRF_TIMER_CC_CHANNEL1 + (src)))
+
+/* Must be well under the 32-bit timer wrap period (71 minutes at 1 MHz) */
+#define TIMEBASE_KEEPALIVE_PERIOD	K_MINUTES(10)
+
+struct timebase_line {
+	struct gpio_callback cb;
+	bool enabled;
+	bool hw_capture;
+	uint64_t last_us;
+	uint32_t count;
+};
+
+static const nrfx_timer_t timer = NRFX_TIMER_INSTANCE(2);
+static struct timebase_line lines[TIMEBASE_SRC_COUNT];
+static const char *const source_names[TIMEBASE_SRC_COUNT] = {
+	[TIMEBASE_SRC_UWB_IRQ] = "UWB IRQ",
+	[TIMEBASE_SRC_INA_ALERT] = "INA ALERT",
+};
+
+static bool ready;
+static uint32_t last_raw;
+static uint64_t epoch;
+
+/* PRIVATE FUNCTIONS **********************************************************/
+
+static void timer_handler(nrf_timer_event_t event_type, void *p_context){
+	// No timer event is enabled
+}
+
+/* Extend a raw counter value to 64 bits. Call with interrupts locked. */
+static uint64_t extend(uint32_t raw){
+	if (raw < last_raw){
+		epoch += BIT64(32);
+	}
+	last_raw = raw;
+
+	return epoch | raw;
+}
+
+static void keepalive_handler(struct k_timer *timer_id){
+	// Read the counter at least once per wrap to keep the extension valid
+	timebase_now_us();
+}
+
+static K_TIMER_DEFINE(keepalive_timer, keepalive_handler, NULL);
+
+static void event_handler(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins){
+	struct timebase_line *line = CONTAINER_OF(cb, struct timebase_line, cb);
+	int src = line - lines;
+	unsigned int key = irq_lock();
+	uint32_t now_raw = nrfx_timer_capture(&timer, TIMEBASE_CC_NOW);
+	uint64_t now = extend(now_raw);
+
+	if (line->hw_capture){
+		// The capture happened at most one wrap before now
+		line->last_us = now - (uint32_t)(now_raw - nrfx_timer_capture_get(&timer, TIMEBASE_CC_SRC(src)));
+	}else{
+		line->last_us = now;
+	}
+	line->count++;
+	irq_unlock(key);
+}
+
+/* PUBLIC FUNCTIONS ***********************************************************/
+
+/** @brief Start the free running timer of the timebase.
+ *
+ * Until this succeeds, timebase_now_us() falls back on the kernel uptime.
+ *
+ * @retval 0 If successful.
+ * @retval -EIO if the timer could not be initialized.
+ */
+int timebase_init(void){
+	nrfx_err_t err;
+	nrfx_timer_config_t config = NRFX_TIMER_DEFAULT_CONFIG(NRFX_MHZ_TO_HZ(1));
+
+	config.bit_width = NRF_TIMER_BIT_WIDTH_32;
+
+	IRQ_CONNECT(DT_IRQN(DT_NODELABEL(timer2)), DT_IRQ(DT_NODELABEL(timer2), priority),
+		nrfx_timer_2_irq_handler, NULL, 0);
+
+	err = nrfx_timer_init(&timer, &config, timer_handler);
+	if (err != NRFX_SUCCESS){
+		printk("Timebase timer init failed (err 0x%x)\n", err);
+		return -EIO;
+	}
+
+	nrfx_timer_enable(&timer);
+	ready = true;
+	k_timer_start(&keepalive_timer, TIMEBASE_KEEPALIVE_PERIOD, TIMEBASE_KEEPALIVE_PERIOD);
+
+	return 0;
+}
+
+/** @brief Timestamp the active edges of an event line.
+ *
+ * The line must already be configured for edge interrupts, by its owner or by
+ * the caller, so the GPIO driver assigned it a GPIOTE channel. Otherwise the
+ * timestamp is taken in software from the GPIO callback.
+ *
+ * @param src Event source of the line.
+ * @param pin GPIO of the line.
+ * @param psel Absolute pin number of the line (NRF_DT_GPIOS_TO_PSEL()).
+ *
+ * @retval 0 If successful.
+ * @retval -output error number.
+ */
+int timebase_capture_enable(enum timebase_source src, const struct gpio_dt_spec *pin, uint32_t psel){
+	struct timebase_line *line;
+	uint8_t gpiote_ch;
+	uint8_t ppi_ch;
+	int err;
+
+	if (!ready || src >= TIMEBASE_SRC_COUNT){
+		return -EINVAL;
+	}
+	line = &lines[src];
+
+	gpio_init_callback(&line->cb, event_handler, BIT(pin->pin));
+	err = gpio_add_callback(pin->port, &line->cb);
+	if (err){
+		printk("Timebase: %s callback failed (err %d)\n", source_names[src], err);
+		return err;
+	}
+
+	if (nrfx_gpiote_channel_get(psel, &gpiote_ch) == NRFX_SUCCESS &&
+		nrfx_gppi_channel_alloc(&ppi_ch) == NRFX_SUCCESS){
+		nrfx_gppi_channel_endpoints_setup(ppi_ch,
+			nrf_gpiote_event_address_get(NRF_GPIOTE, nrf_gpiote_in_event_get(gpiote_ch)),
+			nrfx_timer_capture_task_address_get(&timer, TIMEBASE_CC_SRC(src)));
+		nrfx_gppi_channels_enable(BIT(ppi_ch));
+		line->hw_capture = true;
+	}else{
+		printk("Timebase: no GPIOTE channel for %s, using software timestamps\n", source_names[src]);
+	}
+
+	line->enabled = true;
+
+	return 0;
+}
+
+/** @brief Current time of the timebase.
+ *
+ * @return Time since the timebase started in us.
+ */
+uint64_t timebase_now_us(void){
+	unsigned int key;
+	uint64_t now;
+
+	if (!ready){
+		return k_ticks_to_us_floor64(k_uptime_ticks());
+	}
+
+	key = irq_lock();
+	now = extend(nrfx_timer_capture(&timer, TIMEBASE_CC_NOW));
+	irq_unlock(key);
+
+	return now;
+}
+
+/** @brief Timestamp of the last edge of an event line.
+ *
+ * @param src Event source.
+ *
+ * @return Timestamp in us, 0 if no edge was seen yet.
+ */
+uint64_t timebase_last_event_us(enum timebase_source src){
+	unsigned int key;
+	uint64_t last;
+
+	key = irq_lock();
+	last = lines[src].last_us;
+	irq_unlock(key);
+
+	return last;
+}
+
+/** @brief Number of edges seen on an event line.
+ *
+ * @param src Event source.
+ */
+uint32_t timebase_event_count(enum timebase_source src){
+	return lines[src].count;
+}
+
+/** @brief Print the state of the timebase and of its event lines.
+ */
+void timebase_report(void){
+	uint64_t now = timebase_now_us();
+
+	printk("Timebase: %u.%03u ms (%s)\n", (uint32_t)(now / 1000), (uint32_t)(now % 1000),
+		ready ? "TIMER2" : "uptime");
+	for (int i = 0; i < TIMEBASE_SRC_COUNT; i++){
+		if (!lines[i].enabled){
+			continue;
+		}
+		printk("  %-10s: %u edges || last at %u.%03u ms || %s capture\n", source_names[i],
+			lines[i].count, (uint32_t)(lines[i].last_us / 1000), (uint32_t)(lines[i].last_us % 1000),
+			lines[i].hw_capture ? "PPI" : "software");
+	}
+}
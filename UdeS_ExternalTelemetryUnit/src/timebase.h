@@ -0,0 +1,29 @@
+/** @file       timebase.h
+ *  @brief      Microsecond timebase shared by the samples and the radio events.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+/* INCLUDES *******************************************************************/
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/gpio.h>
+
+/* Event lines timestamped by the timebase */
+enum timebase_source {
+	TIMEBASE_SRC_UWB_IRQ,
+	TIMEBASE_SRC_INA_ALERT,
+	TIMEBASE_SRC_COUNT
+};
+
+/* PUBLIC FUNCTION PROTOTYPES *************************************************/
+int timebase_init(void);
+int timebase_capture_enable(enum timebase_source src, const struct gpio_dt_spec *pin, uint32_t psel);
+uint64_t timebase_now_us(void);
+uint64_t timebase_last_event_us(enum timebase_source src);
+uint32_t timebase_event_count(enum timebase_source src);
+void timebase_report(void);
+
+#endif /* TIMEBASE_H_ */
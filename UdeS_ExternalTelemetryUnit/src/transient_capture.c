@@ -0,0 +1,263 @@
+/** @file       transient_capture.c
+ *  @brief      Triggered high-rate current capture of an ina231 rail.
+ *
+ *  Works like the single shot mode of an oscilloscope. The rail runs fast
+ *  continuous shunt conversions and the conversion ready flag is polled.
+ *  The current of every new conversion is pushed into a ring buffer, once.
+ *  A trigger freezes the PRE samples before it and the POST samples from
+ *  it on. The frozen capture is then dumped over the USB console and
+ *  the capture is re-armed after a holdoff.
+ *
+ *  The threshold trigger uses the latched shunt over-voltage alert of the
+ *  ina231. The alert is checked on every conversion, so a spike shorter than
+ *  the read period still fires it.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+/* INCLUDES *******************************************************************/
+#include "transient_capture.h"
+#include "timebase.h"
+
+#define PRE_SAMPLES		CONFIG_APP_TRANSIENT_CAPTURE_PRE_SAMPLES
+#define POST_SAMPLES	CONFIG_APP_TRANSIENT_CAPTURE_POST_SAMPLES
+#define RING_SIZE		(PRE_SAMPLES + POST_SAMPLES)
+
+/* Shunt voltage register LSB is 2.5 uV */
+#define SHUNT_LSB_NV	2500
+
+BUILD_ASSERT(POST_SAMPLES > 0, "The trigger sample is part of the post-trigger samples");
+
+enum capture_state {
+	CAPTURE_IDLE,
+	CAPTURE_ARMED,
+	CAPTURE_TRIGGERED,
+	CAPTURE_READY,
+	CAPTURE_DUMPING,
+};
+
+struct capture_sample {
+	uint32_t t_us;		/* Low 32 bits of the timebase */
+	int16_t raw;		/* Current register */
+};
+
+static struct ina23x_data *capture_rail;
+static uint32_t threshold_uA;
+static struct capture_sample ring[RING_SIZE];
+static uint32_t head;		/* Next write index */
+static uint32_t filled;		/* Valid samples in the ring */
+static uint32_t post_left;
+static uint64_t trigger_us;
+static const char *trigger_cause;
+static uint32_t dump_pos;
+static uint32_t capture_count;
+static uint32_t read_errors;
+static atomic_t state;
+static atomic_t manual_trigger;
+
+static K_SEM_DEFINE(arm_sem, 0, 1);
+static K_SEM_DEFINE(dumped_sem, 0, 1);
+
+static void capture_task(void *p1, void *p2, void *p3);
+
+K_THREAD_DEFINE(transient_capture_tid, CONFIG_APP_TRANSIENT_CAPTURE_STACK_SIZE, capture_task,
+	NULL, NULL, NULL, CONFIG_APP_TRANSIENT_CAPTURE_PRIORITY, 0, 0);
+
+/* PRIVATE FUNCTIONS **********************************************************/
+
+static void ring_push(int16_t raw, uint32_t t_us){
+	ring[head].raw = raw;
+	ring[head].t_us = t_us;
+	head = (head + 1) % RING_SIZE;
+	if (filled < RING_SIZE){
+		filled++;
+	}
+}
+
+/* Check every trigger source against a new sample. Returns the cause or NULL. */
+static const char *check_trigger(int16_t raw, uint64_t t_us, bool alert, uint32_t *uwb_irqs){
+	uint32_t irqs;
+
+	if (atomic_cas(&manual_trigger, 1, 0)){
+		trigger_us = t_us;
+		return "manual";
+	}
+
+	if (IS_ENABLED(CONFIG_APP_TRANSIENT_CAPTURE_TRIGGER_UWB_IRQ)){
+		irqs = timebase_event_count(TIMEBASE_SRC_UWB_IRQ);
+		if (irqs != *uwb_irqs){
+			*uwb_irqs = irqs;
+			trigger_us = timebase_last_event_us(TIMEBASE_SRC_UWB_IRQ);
+			return "UWB IRQ";
+		}
+	}
+
+	if (((int64_t)raw * capture_rail->current_lsb_uA >= (int64_t)threshold_uA) || alert){
+		trigger_us = t_us;
+		return "threshold";
+	}
+
+	return NULL;
+}
+
+static void capture_task(void *p1, void *p2, void *p3){
+	uint16_t raw;
+	uint16_t mask;
+	uint64_t now;
+	uint32_t uwb_irqs;
+	bool alert;
+
+	for (;;){
+		k_sem_take(&arm_sem, K_FOREVER);
+
+		head = 0;
+		filled = 0;
+		trigger_cause = NULL;
+		uwb_irqs = timebase_event_count(TIMEBASE_SRC_UWB_IRQ);
+		alert = false;
+		ina23x_alert_enable_read(capture_rail, &mask);
+		atomic_set(&state, CAPTURE_ARMED);
+
+		while (atomic_get(&state) == CAPTURE_ARMED || atomic_get(&state) == CAPTURE_TRIGGERED){
+			if (ina23x_alert_enable_read(capture_rail, &mask)){
+				read_errors++;
+				k_sleep(K_TICKS(1));
+				continue;
+			}
+			// Reading the Mask/Enable register clears both flags, keep the
+			// latched alert until the next sample
+			alert |= (mask & INA231_ALERT_FUNCTION_FLAG) != 0;
+			if (!(mask & INA231_CONVERSION_READY_FLAG)){
+				continue;
+			}
+			now = timebase_now_us();
+			if (ina23x_read(capture_rail, INA23X_CURRENT, &raw)){
+				read_errors++;
+				k_sleep(K_TICKS(1));
+				continue;
+			}
+			ring_push((int16_t)raw, (uint32_t)now);
+
+			if (atomic_get(&state) == CAPTURE_ARMED){
+				trigger_cause = check_trigger((int16_t)raw, now, alert, &uwb_irqs);
+				alert = false;
+				if (!trigger_cause){
+					continue;
+				}
+				post_left = POST_SAMPLES - 1;
+				atomic_set(&state, CAPTURE_TRIGGERED);
+			}else{
+				post_left--;
+			}
+
+			if (!post_left){
+				capture_count++;
+				atomic_set(&state, CAPTURE_READY);
+			}
+		}
+
+		// Wait for the console to dump the capture, then re-arm after the holdoff
+		k_sem_take(&dumped_sem, K_FOREVER);
+		k_sleep(K_MSEC(CONFIG_APP_TRANSIENT_CAPTURE_HOLDOFF_MS));
+		k_sem_give(&arm_sem);
+	}
+}
+
+/* PUBLIC FUNCTIONS ***********************************************************/
+
+/** @brief Reserve a rail for the capture, set its alert and arm the capture.
+ *
+ * @param rail ina23x of the captured rail.
+ * @param threshold Current in uA that fires the threshold trigger.
+ *
+ * @retval 0 If successful.
+ * @retval -output error number.
+ */
+int transient_capture_init(struct ina23x_data *rail, uint32_t threshold){
+	uint64_t limit = (uint64_t)threshold * rail->rshunt / SHUNT_LSB_NV / 1000;
+	int err = 0;
+
+	// Only the current is captured, skipping the bus conversions doubles the rate
+	err += ina23x_write(rail, INA23X_CONFIG, INA231_CONFIG_FAST_SHUNT);
+	err += ina23x_alert_limit_set(rail, MIN(limit, INT16_MAX));
+	err += ina23x_alert_enable_set(rail, INA231_SHUNT_OVER_VOLTAGE_BIT, 0, 1);
+	if (err){
+		printk("Transient capture: failed to configure ina@%x\n", rail->devSpec.addr);
+		return -EIO;
+	}
+
+	capture_rail = rail;
+	threshold_uA = threshold;
+	printk("Transient capture armed on ina@%x (%u uA, %u pre, %u post samples)\n",
+		rail->devSpec.addr, threshold, PRE_SAMPLES, POST_SAMPLES);
+	k_sem_give(&arm_sem);
+
+	return 0;
+}
+
+/** @brief Check if a rail is reserved by the capture.
+ *
+ * @param rail ina23x to check.
+ *
+ * @return TRUE if the rail must not be used by anyone else.
+ */
+bool transient_capture_owns(const struct ina23x_data *rail){
+	return capture_rail && capture_rail == rail;
+}
+
+/** @brief Fire the trigger from an external event.
+ *
+ * Ignored if the capture is not armed.
+ */
+void transient_capture_trigger(void){
+	if (atomic_get(&state) == CAPTURE_ARMED){
+		atomic_set(&manual_trigger, 1);
+	}
+}
+
+/** @brief Dump the frozen capture over the console.
+ *
+ * Meant to be called periodically by the console task. The capture is sent
+ * in chunks of CONFIG_APP_TRANSIENT_CAPTURE_DUMP_CHUNK lines so a long dump
+ * does not hold the console. Data lines are "C,<t_us>,<current_uA>" with the
+ * time relative to the trigger. Only these lines belong to the capture,
+ * messages of other threads can still come between the markers.
+ *
+ * @return TRUE while the dump is not over. The console task then holds
+ * back its own output so the capture stays contiguous.
+ */
+bool transient_capture_dump(void){
+	uint32_t start;
+	uint32_t end;
+
+	if (atomic_get(&state) == CAPTURE_READY){
+		printk("#CAPTURE %u ina@%x trigger=%s t=%u.%03u ms pre=%u post=%u errors=%u\n",
+			capture_count, capture_rail->devSpec.addr, trigger_cause,
+			(uint32_t)(trigger_us / 1000), (uint32_t)(trigger_us % 1000),
+			filled - POST_SAMPLES, POST_SAMPLES, read_errors);
+		dump_pos = 0;
+		atomic_set(&state, CAPTURE_DUMPING);
+	}
+	if (atomic_get(&state) != CAPTURE_DUMPING){
+		return false;
+	}
+
+	// The ring is frozen from READY until the dump ends, read it only then
+	start = (head + RING_SIZE - filled) % RING_SIZE;
+	end = MIN(dump_pos + CONFIG_APP_TRANSIENT_CAPTURE_DUMP_CHUNK, filled);
+	for (; dump_pos < end; dump_pos++){
+		const struct capture_sample *s = &ring[(start + dump_pos) % RING_SIZE];
+
+		printk("C,%d,%d\n", (int32_t)(s->t_us - (uint32_t)trigger_us),
+			(int)(s->raw * capture_rail->current_lsb_uA));
+	}
+
+	if (dump_pos == filled){
+		printk("#END\n");
+		atomic_set(&state, CAPTURE_IDLE);
+		k_sem_give(&dumped_sem);
+		return false;
+	}
+
+	return true;
+}
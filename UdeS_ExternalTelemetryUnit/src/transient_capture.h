@@ -0,0 +1,34 @@
+/** @file       transient_capture.h
+ *  @brief      Triggered high-rate current capture of an ina231 rail.
+ *
+ *  @date       Created on October 19th, 2026
+ */
+
+#ifndef TRANSIENT_CAPTURE_H_
+#define TRANSIENT_CAPTURE_H_
+
+/* INCLUDES *******************************************************************/
+#include <zephyr/kernel.h>
+#include "INA231.h"
+
+/* PUBLIC FUNCTION PROTOTYPES *************************************************/
+#if defined(CONFIG_APP_TRANSIENT_CAPTURE)
+int transient_capture_init(struct ina23x_data *rail, uint32_t threshold_uA);
+bool transient_capture_owns(const struct ina23x_data *rail);
+void transient_capture_trigger(void);
+bool transient_capture_dump(void);
+#else
+static inline int transient_capture_init(struct ina23x_data *rail, uint32_t threshold_uA){
+	return 0;
+}
+static inline bool transient_capture_owns(const struct ina23x_data *rail){
+	return false;
+}
+static inline void transient_capture_trigger(void){
+}
+static inline bool transient_capture_dump(void){
+	return false;
+}
+#endif
+
+#endif /* TRANSIENT_CAPTURE_H_ */